@@ -0,0 +1,431 @@
+﻿// 規則差異模糊測試工具
+//
+// 以隨機的合法對局同時驅動 Board（參考實作）與 FastBoard（最佳化實作），
+// 每一步都對每一組（棋子, 空格）在兩者的副本上實際嘗試移動，比對是否同樣接受或拒絕，
+// 以及合法移動集合、跳躍結果與移動後的完整狀態。
+// 發現差異時會縮減成最短的重現步驟，觸發差異的移動（即使被拒絕）放在最後，寫入 fuzz_repro_<種子>.txt，
+// 格式與 tuner 的對局紀錄相同（獲勝隊伍欄位為 -），可用 --replay 重新執行。
+//
+// 同時檢查每步持續同步的 RouteAnalysis 快取結果與重新建立的結果一致。
+//
+// 用法：fuzzer [對局數] [執行緒數] [起始種子] [每局最大步數]
+//       fuzzer --replay <重現檔>
+#include "../hw1/Board.h"          // 包含參考實作的棋盤類別
+#include "../hw1/Eval.h"           // 包含評估類別，比對兩種棋盤擷取的特徵
+#include "../hw1/FastBoard.h"      // 包含最佳化的棋盤類別
+#include "../hw1/RouteAnalysis.h"  // 包含回合數分析類別
+#include <algorithm>               // 包含演算法函式
+#include <atomic>                  // 包含原子變數
+#include <cctype>                  // 包含字元分類函式
+#include <cerrno>                  // 包含錯誤碼
+#include <cstdlib>                 // 包含字串轉數字函式
+#include <fstream>                 // 包含檔案串流
+#include <iostream>                // 包含輸入輸出流
+#include <limits>                  // 包含數值範圍
+#include <mutex>                   // 包含互斥鎖
+#include <random>                  // 包含亂數產生器
+#include <sstream>                 // 包含字串流
+#include <string>                  // 包含字串類別
+#include <thread>                  // 包含執行緒
+#include <vector>                  // 包含動態陣列容器
+using namespace std;               // 使用標準命名空間
+
+namespace {
+
+// 對局中的一個動作：移動棋子，或在連續跳躍中選擇停止
+struct Action {
+    bool stop = false;  // 是否為中斷連續跳躍
+    Hex from, to;       // 移動的起點與終點
+};
+
+// 重播的結果
+enum class ReplayStatus {
+    SAME,      // 兩種實作完全一致
+    DIVERGED,  // 發現差異
+    INVALID    // 動作序列在參考實作中不合法（縮減時使用）
+};
+
+// 發現的差異
+struct Divergence {
+    string message;        // 差異描述
+    bool hasMove = false;  // 是否由某個嘗試的移動觸發
+    Action move;           // 觸發差異的移動，寫入重現檔的最後一個動作
+};
+
+// 座標排序，用於比較集合
+bool hexLess(const Hex& a, const Hex& b) {
+    return a.q != b.q ? a.q < b.q : a.r < b.r;
+}
+
+bool moveLess(const pair<Hex, Hex>& a, const pair<Hex, Hex>& b) {
+    if (!(a.first == b.first)) return hexLess(a.first, b.first);
+    return hexLess(a.second, b.second);
+}
+
+// 座標轉換為字串
+string hexString(const Hex& hex) {
+    return "(" + to_string(hex.q) + "," + to_string(hex.r) + ")";
+}
+
+// 比較兩種實作的完整狀態，回傳差異描述（相同時為空字串）
+string compareState(const Board& reference, const FastBoard& fast) {
+    ostringstream diff;
+
+    if (reference.getWinner() != fast.getWinner()) {
+        diff << "winner " << (reference.getWinner() ? reference.getWinner() : '-') << " vs "
+            << (fast.getWinner() ? fast.getWinner() : '-') << "; ";
+    }
+    for (char team : {Board::RED, Board::BLUE, Board::GREEN}) {
+        if (Evaluator::extract(reference, team) != Evaluator::extract(fast, team)) diff << "features " << team << " differ; ";
+    }
+    if (reference.getCurrentPlayer() != fast.getCurrentPlayer()) {
+        diff << "current player " << reference.getCurrentPlayer() << " vs " << fast.getCurrentPlayer() << "; ";
+    }
+    if (!(reference.getMustMoveFrom() == fast.getMustMoveFrom())) {
+        diff << "mustMoveFrom " << hexString(reference.getMustMoveFrom()) << " vs "
+            << hexString(fast.getMustMoveFrom()) << "; ";
+    }
+    if (!(reference.getLastMoveFrom() == fast.getLastMoveFrom())) {
+        diff << "lastMoveFrom " << hexString(reference.getLastMoveFrom()) << " vs "
+            << hexString(fast.getLastMoveFrom()) << "; ";
+    }
+
+    vector<Hex> referenceHistory(reference.getJumpHistory().begin(), reference.getJumpHistory().end());
+    vector<Hex> fastHistory = fast.getJumpHistory();
+    sort(referenceHistory.begin(), referenceHistory.end(), hexLess);
+    sort(fastHistory.begin(), fastHistory.end(), hexLess);
+    if (referenceHistory != fastHistory) diff << "jumpHistory differs; ";
+
+    for (const auto& [pos, value] : reference.getGrid()) {
+        if (value != fast.at(pos)) {
+            diff << "cell " << hexString(pos) << " " << value << " vs " << fast.at(pos) << "; ";
+        }
+
+        // 跳躍搜尋本身也逐格比對，差異通常先在這裡出現
+        if (value == Board::RED || value == Board::BLUE || value == Board::GREEN) {
+            vector<Hex> referenceJumps = reference.getJumpMoves(pos, reference.getLastMoveFrom());
+            vector<Hex> fastJumps = fast.getJumpMoves(pos, reference.getLastMoveFrom());
+            sort(referenceJumps.begin(), referenceJumps.end(), hexLess);
+            sort(fastJumps.begin(), fastJumps.end(), hexLess);
+            if (referenceJumps != fastJumps) diff << "getJumpMoves" << hexString(pos) << " differs; ";
+        }
+    }
+    return diff.str();
+}
+
+// 在兩種實作的副本上嘗試每一組（棋子, 空格）的移動，比對是否同樣接受或拒絕，
+// 以及接受後的狀態是否一致。accepted 回傳參考實作接受的移動（已排序），
+// 發現差異時 divergence 記錄觸發差異的移動
+bool compareAttempts(const Board& reference, const FastBoard& fast,
+    vector<pair<Hex, Hex>>& accepted, Divergence& divergence) {
+    accepted.clear();
+    for (const auto& [from, piece] : reference.getGrid()) {
+        if (piece == Board::EMPTY) continue;  // 其他隊伍的棋子也要嘗試，確認會被拒絕
+        for (const auto& [to, target] : reference.getGrid()) {
+            if (target != Board::EMPTY) continue;
+            Board referenceCopy = reference;  // 在副本上嘗試，避免改變原局面
+            FastBoard fastCopy = fast;
+            bool referenceAccepted = referenceCopy.move(from, to);
+            bool fastAccepted = fastCopy.move(from, to);
+
+            string message;
+            if (referenceAccepted != fastAccepted) {
+                message = string(referenceAccepted ? "FastBoard rejected " : "FastBoard accepted ")
+                    + hexString(from) + "->" + hexString(to);
+            }
+            else if (referenceAccepted) {
+                message = compareState(referenceCopy, fastCopy);
+                if (!message.empty()) message = "after " + hexString(from) + "->" + hexString(to) + ": " + message;
+            }
+            if (!message.empty()) {
+                divergence.message = message;
+                divergence.hasMove = true;
+                divergence.move.from = from;
+                divergence.move.to = to;
+                return false;
+            }
+            if (referenceAccepted) accepted.push_back({ from, to });
+        }
+    }
+    sort(accepted.begin(), accepted.end(), moveLess);
+    return true;
+}
+
+// 比較兩種實作的合法移動集合，回傳差異描述
+string compareMoves(const vector<pair<Hex, Hex>>& referenceMoves, vector<pair<Hex, Hex>> fastMoves) {
+    sort(fastMoves.begin(), fastMoves.end(), moveLess);
+    if (referenceMoves == fastMoves) return "";
+
+    ostringstream diff;
+    for (const auto& move : referenceMoves) {
+        if (!binary_search(fastMoves.begin(), fastMoves.end(), move, moveLess)) {
+            diff << "missing " << hexString(move.first) << "->" << hexString(move.second) << "; ";
+        }
+    }
+    for (const auto& move : fastMoves) {
+        if (!binary_search(referenceMoves.begin(), referenceMoves.end(), move, moveLess)) {
+            diff << "extra " << hexString(move.first) << "->" << hexString(move.second) << "; ";
+        }
+    }
+    return diff.str();
+}
+
+// 比較持續同步的回合數分析與重新建立的結果，回傳差異描述
+string compareRoutes(RouteAnalysis& routes, const Board& board) {
+    routes.update(board);
+    RouteAnalysis fresh;  // 第一次 update 會完整計算
+    fresh.update(board);
+
+    ostringstream diff;
+    for (const auto& [pos, value] : board.getGrid()) {
+        for (char team : {Board::RED, Board::BLUE, Board::GREEN}) {
+            if (routes.getDistance(pos, team) != fresh.getDistance(pos, team)) {
+                diff << "route distance " << team << hexString(pos) << " " << routes.getDistance(pos, team)
+                    << " vs " << fresh.getDistance(pos, team) << "; ";
+            }
+        }
+        if (routes.getTurnsToGoal(pos) != fresh.getTurnsToGoal(pos)) {
+            diff << "turns to goal " << hexString(pos) << " differs; ";
+        }
+    }
+    return diff.str();
+}
+
+// 比對目前局面的狀態、每一組嘗試的移動、合法移動集合與回合數分析
+// accepted 回傳參考實作接受的移動，發現差異時回傳 false
+bool checkPly(const Board& reference, const FastBoard& fast, RouteAnalysis& routes,
+    vector<pair<Hex, Hex>>& accepted, Divergence& divergence) {
+    divergence = Divergence();
+    divergence.message = compareState(reference, fast);
+    if (divergence.message.empty() && !compareAttempts(reference, fast, accepted, divergence)) return false;
+    if (divergence.message.empty()) divergence.message = compareMoves(accepted, fast.getLegalMoves());
+    if (divergence.message.empty()) divergence.message = compareRoutes(routes, reference);
+    return divergence.message.empty();
+}
+
+// 依序執行動作並在每一步比對兩種實作
+// length 回傳發生差異時已執行的動作數，divergence 回傳差異描述
+ReplayStatus replay(const vector<Action>& actions, size_t& length, Divergence& divergence) {
+    Board reference;
+    FastBoard fast;
+    RouteAnalysis routes;
+    vector<pair<Hex, Hex>> accepted;
+
+    for (length = 0; ; ++length) {
+        if (!checkPly(reference, fast, routes, accepted, divergence)) return ReplayStatus::DIVERGED;
+        if (length == actions.size()) return ReplayStatus::SAME;
+
+        const Action& action = actions[length];
+        if (action.stop) {
+            if (!reference.isInJumpSequence()) return ReplayStatus::INVALID;
+            reference.stopJumpSequence();
+            fast.stopJumpSequence();
+            continue;
+        }
+
+        // 序列中也可以有被拒絕的移動，兩種實作都拒絕時局面不變
+        bool referenceAccepted = reference.move(action.from, action.to);
+        if (referenceAccepted != fast.move(action.from, action.to)) {
+            divergence.message = string(referenceAccepted ? "FastBoard rejected " : "FastBoard accepted ")
+                + hexString(action.from) + "->" + hexString(action.to);
+            divergence.hasMove = true;
+            divergence.move = action;
+            return ReplayStatus::DIVERGED;
+        }
+    }
+}
+
+// 逐一嘗試刪除動作，保留仍能重現差異的最短序列
+// 差異由某個嘗試的移動觸發時，該移動（即使被拒絕）會放在序列的最後
+vector<Action> minimize(vector<Action> actions) {
+    size_t length;
+    Divergence divergence;
+    replay(actions, length, divergence);
+    actions.resize(length);  // 差異之後的動作不需要
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (size_t i = actions.size(); i-- > 0;) {
+            if (i >= actions.size()) continue;
+            vector<Action> candidate = actions;
+            candidate.erase(candidate.begin() + i);
+            if (replay(candidate, length, divergence) == ReplayStatus::DIVERGED) {
+                candidate.resize(length);
+                actions = candidate;
+                progress = true;
+            }
+        }
+    }
+
+    replay(actions, length, divergence);
+    if (divergence.hasMove) actions.push_back(divergence.move);
+    return actions;
+}
+
+// 將動作序列寫成對局紀錄格式
+string formatActions(const vector<Action>& actions) {
+    ostringstream oss;
+    oss << '-';  // 獲勝隊伍欄位，重現檔沒有勝負
+    for (const Action& action : actions) {
+        if (action.stop) oss << " S";
+        else oss << ' ' << action.from.q << ' ' << action.from.r << ' ' << action.to.q << ' ' << action.to.r;
+    }
+    return oss.str();
+}
+
+// 讀取對局紀錄格式的動作序列
+bool parseActions(const string& line, vector<Action>& actions) {
+    istringstream iss(line);
+    string token;
+    if (!(iss >> token)) return false;  // 略過獲勝隊伍欄位
+    while (iss >> token) {
+        Action action;
+        if (token == "S") {
+            action.stop = true;
+        }
+        else {
+            istringstream first(token);
+            if (!(first >> action.from.q)) return false;
+            if (!(iss >> action.from.r >> action.to.q >> action.to.r)) return false;
+        }
+        actions.push_back(action);
+    }
+    return true;
+}
+
+// 以指定種子進行一局隨機對局，發現差異時回傳 true
+bool playGame(unsigned seed, int maxPlies, vector<Action>& actions, Divergence& divergence) {
+    mt19937 rng(seed);
+    Board reference;
+    FastBoard fast;
+    RouteAnalysis routes;
+    vector<pair<Hex, Hex>> moves;
+
+    for (int ply = 0; ply < maxPlies && !reference.checkWin(); ++ply) {
+        if (!checkPly(reference, fast, routes, moves, divergence)) return true;
+
+        // 連續跳躍中有一定機率選擇停止，讓兩種分支都被測試到
+        Action action;
+        if (reference.isInJumpSequence() && (moves.empty() || rng() % 3 == 0)) {
+            action.stop = true;
+            reference.stopJumpSequence();
+            fast.stopJumpSequence();
+        }
+        else {
+            if (moves.empty()) break;  // 沒有合法移動，結束這局
+            const auto& move = moves[rng() % moves.size()];
+            action.from = move.first;
+            action.to = move.second;
+            reference.move(action.from, action.to);
+            fast.move(action.from, action.to);  // checkPly 已確認兩者都接受這個移動
+        }
+        actions.push_back(action);
+    }
+
+    divergence = Divergence();
+    divergence.message = compareState(reference, fast);
+    return !divergence.message.empty();
+}
+
+// 解析正整數參數，格式錯誤、超出範圍或不是正數時回傳 false
+bool parsePositive(const char* text, long& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = strtol(text, &end, 10);
+    return end != text && *end == '\0' && errno != ERANGE && value > 0;
+}
+
+// 解析種子參數，接受 0 到 unsigned 上限的整數，與輸出的種子格式相同
+bool parseSeed(const char* text, unsigned& value) {
+    if (!isdigit(static_cast<unsigned char>(*text))) return false;  // strtoull 會接受負號
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed > numeric_limits<unsigned>::max()) return false;
+    value = static_cast<unsigned>(parsed);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const char* usage = "Usage: fuzzer [games] [threads] [seed] [max plies]\n"
+        "       fuzzer --replay <file>\n";
+
+    // 重新執行重現檔
+    if (argc > 1 && string(argv[1]) == "--replay") {
+        if (argc != 3) {
+            cout << usage;
+            return 1;
+        }
+        ifstream in(argv[2]);
+        string line, last;
+        while (getline(in, line)) {
+            if (!line.empty() && line[0] != '#') last = line;  // 取最後一行動作序列
+        }
+        vector<Action> actions;
+        if (!parseActions(last, actions)) {
+            cout << "Cannot parse " << argv[2] << "\n";
+            return 1;
+        }
+        size_t length;
+        Divergence divergence;
+        ReplayStatus status = replay(actions, length, divergence);
+        if (status == ReplayStatus::SAME) cout << "No divergence after " << length << " actions\n";
+        else if (status == ReplayStatus::INVALID) cout << "Action " << length + 1 << " is illegal in Board\n";
+        else cout << "Diverged after " << length << " actions: " << divergence.message << "\n";
+        return status == ReplayStatus::SAME ? 0 : 1;
+    }
+
+    long games = 1000, threadCount = max(1u, thread::hardware_concurrency()), maxPlies = 300;
+    unsigned baseSeed = 0;
+    if (argc > 5 || (argc > 1 && !parsePositive(argv[1], games)) ||
+        (argc > 2 && !parsePositive(argv[2], threadCount)) ||
+        (argc > 3 && !parseSeed(argv[3], baseSeed)) ||
+        (argc > 4 && !parsePositive(argv[4], maxPlies))) {
+        cout << usage;
+        return 1;
+    }
+    if (argc <= 3) baseSeed = random_device{}();  // 沒有指定種子時隨機產生，輸出後可以重新指定
+
+    cout << "Fuzzing " << games << " games with " << threadCount << " threads, seed " << baseSeed << "\n";
+
+    atomic<long> nextGame{ 0 };   // 下一局的編號
+    atomic<bool> found{ false };  // 是否已發現差異
+    atomic<long long> plies{ 0 }; // 已比對的步數
+    mutex outputMutex;
+    vector<thread> workers;
+
+    for (long t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&] {
+            long game;
+            while (!found && (game = nextGame++) < games) {
+                unsigned gameSeed = baseSeed + static_cast<unsigned>(game);  // 每局有獨立種子以便重現
+                vector<Action> actions;
+                Divergence divergence;
+                bool diverged = playGame(gameSeed, static_cast<int>(maxPlies), actions, divergence);
+                plies += static_cast<long long>(actions.size());
+                if (!diverged || found.exchange(true)) continue;
+
+                // 只由第一個發現差異的執行緒負責縮減與輸出
+                vector<Action> minimal = minimize(actions);
+                size_t length;
+                replay(minimal, length, divergence);
+
+                string path = "fuzz_repro_" + to_string(gameSeed) + ".txt";
+                ofstream out(path);
+                out << "# " << divergence.message << "\n" << formatActions(minimal) << "\n";
+
+                lock_guard<mutex> lock(outputMutex);
+                cout << "Divergence in game seed " << gameSeed << ": " << divergence.message << "\n";
+                cout << "Minimal reproduction (" << minimal.size() << " actions) written to " << path << "\n";
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    if (found) return 1;
+    cout << "No divergence in " << games << " games (" << plies << " plies)\n";
+    return 0;
+}
@@ -0,0 +1,127 @@
+﻿#include "Eval.h"       // 包含評估類別的標頭檔
+#include "FastBoard.h"  // 包含快速棋盤類別
+#include <algorithm>    // 包含演算法函式
+#include <cstdlib>      // 包含abs
+using namespace std;    // 使用標準命名空間
+
+// 取得指定隊伍目標區域的所有格子
+const vector<Hex>& Evaluator::getTargetCells(char team) {
+    // 目標區域只取決於棋盤形狀，第一次呼叫時從初始棋盤建立後快取
+    static const vector<vector<Hex>> targetCells = [] {
+        Board board;  // 初始棋盤，只用來取得所有格子的座標
+        vector<vector<Hex>> cells(3);
+        const char teams[] = { Board::RED, Board::BLUE, Board::GREEN };
+        for (int i = 0; i < 3; ++i) {
+            for (const auto& [pos, value] : board.getGrid()) {
+                if (board.isInTargetArea(pos, teams[i])) {
+                    cells[i].push_back(pos);  // 記錄屬於該隊伍目標區域的格子
+                }
+            }
+        }
+        return cells;
+    }();
+
+    static const vector<Hex> none;  // 未知隊伍沒有目標區域
+    switch (team) {
+    case Board::RED: return targetCells[0];
+    case Board::BLUE: return targetCells[1];
+    case Board::GREEN: return targetCells[2];
+    default: return none;
+    }
+}
+
+// 計算兩個格子之間的最少單步移動次數
+// 棋盤的可用格子採用雙倍欄座標，相鄰格子為 (±2,0) 與 (±1,±1)，
+// 因此不能使用 Hex::distance 的軸座標公式，否則左右方向會不對稱
+int Evaluator::stepDistance(const Hex& a, const Hex& b) {
+    int dq = abs(a.q - b.q);
+    int dr = abs(a.r - b.r);
+    return max(dr, (dq + dr) / 2);
+}
+
+// 計算指定位置到某隊伍目標區域最近格子的距離
+int Evaluator::targetDistance(const Hex& hex, char team) {
+    int best = 0;
+    bool found = false;
+    for (const Hex& cell : getTargetCells(team)) {
+        int dist = stepDistance(hex, cell);  // 到該目標格子的單步移動次數
+        if (!found || dist < best) {
+            best = dist;
+            found = true;
+        }
+    }
+    return best;  // 已在目標區域內時距離為0
+}
+
+// 將一顆棋子的貢獻累加到特徵值
+void Evaluator::addPiece(EvalFeatures& features, const Hex& pos, char team) {
+    // 到目標區域的距離：累加總和並記錄落後最多的棋子
+    int dist = targetDistance(pos, team);
+    features[GOAL_DISTANCE] += dist;
+    features[STRAGGLER] = max(features[STRAGGLER], dist);
+
+    // 佔據其他隊伍的目標區域會阻擋對手進入
+    for (char other : {Board::RED, Board::BLUE, Board::GREEN}) {
+        const vector<Hex>& cells = getTargetCells(other);
+        if (other != team && find(cells.begin(), cells.end(), pos) != cells.end()) {
+            features[BLOCKING]++;
+        }
+    }
+}
+
+// 擷取指定隊伍在目前局面下的特徵值
+EvalFeatures Evaluator::extract(const Board& board, char team) {
+    EvalFeatures features{};  // 所有特徵初始化為0
+    for (const auto& [pos, piece] : board.getGrid()) {
+        if (piece == team) addPiece(features, pos, team);  // 只計算該隊伍的棋子
+    }
+    return features;
+}
+
+// 擷取指定隊伍在目前局面下的特徵值（快速棋盤）
+// tuner 重播時每個局面都要擷取三隊的特徵，因此預先計算每個格子對每個隊伍的貢獻
+EvalFeatures Evaluator::extract(const FastBoard& board, char team) {
+    static const vector<vector<EvalFeatures>> contributions = [] {
+        const char teams[] = { Board::RED, Board::BLUE, Board::GREEN };
+        vector<vector<EvalFeatures>> result(3, vector<EvalFeatures>(FastBoard::getCellCount()));
+        for (int t = 0; t < 3; ++t) {
+            for (int i = 0; i < FastBoard::getCellCount(); ++i) {
+                result[t][i] = EvalFeatures{};
+                addPiece(result[t][i], FastBoard::toHex(i), teams[t]);  // 單顆棋子的貢獻
+            }
+        }
+        return result;
+    }();
+
+    int t = team == Board::RED ? 0 : team == Board::BLUE ? 1 : team == Board::GREEN ? 2 : -1;
+    EvalFeatures features{};
+    if (t < 0) return features;  // 未知隊伍沒有棋子
+    int count = FastBoard::getCellCount();
+    for (int i = 0; i < count; ++i) {
+        if (board.at(i) != team) continue;
+        const EvalFeatures& piece = contributions[t][i];
+        features[GOAL_DISTANCE] += piece[GOAL_DISTANCE];
+        features[STRAGGLER] = max(features[STRAGGLER], piece[STRAGGLER]);
+        features[BLOCKING] += piece[BLOCKING];
+    }
+    return features;
+}
+
+// 以編譯期權重計算特徵值的分數
+int Evaluator::evaluate(const EvalFeatures& features) {
+    int score = 0;
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        score += WEIGHTS[i] * features[i];  // 加權總和
+    }
+    return score;
+}
+
+// 計算指定隊伍在目前局面下的分數
+int Evaluator::evaluate(const Board& board, char team) {
+    return evaluate(extract(board, team));
+}
+
+// 計算指定隊伍在目前局面下的分數（快速棋盤）
+int Evaluator::evaluate(const FastBoard& board, char team) {
+    return evaluate(extract(board, team));
+}
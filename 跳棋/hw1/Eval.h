@@ -0,0 +1,53 @@
+﻿#pragma once  // 防止標頭檔重複包含
+#include "Board.h"        // 包含棋盤類別
+#include "EvalWeights.h"  // 包含評估權重常數
+#include <array>          // 包含固定長度陣列
+#include <vector>         // 包含動態陣列容器
+
+// 評估特徵的索引
+enum EvalFeature {
+    GOAL_DISTANCE = 0,  // 所有棋子到目標區域的距離總和
+    STRAGGLER,          // 落後最多的棋子到目標區域的距離
+    BLOCKING,           // 佔據其他隊伍目標區域的棋子數量
+    FEATURE_COUNT       // 特徵數量
+};
+
+// 單一隊伍在某個局面下的特徵值
+using EvalFeatures = std::array<int, FEATURE_COUNT>;
+
+class FastBoard;  // 快速棋盤類別（FastBoard.h）
+
+// 評估類別，負責從棋盤擷取特徵並計算局面分數
+class Evaluator {
+public:
+    // 依特徵索引排列的權重，與 EvalFeature 的順序一致
+    static constexpr std::array<int, FEATURE_COUNT> WEIGHTS = {
+        EvalWeights::GOAL_DISTANCE,
+        EvalWeights::STRAGGLER,
+        EvalWeights::BLOCKING
+    };
+
+    // 擷取指定隊伍在目前局面下的特徵值
+    static EvalFeatures extract(const Board& board, char team);
+    static EvalFeatures extract(const FastBoard& board, char team);
+
+    // 以編譯期權重計算特徵值的分數（越高對該隊伍越有利）
+    static int evaluate(const EvalFeatures& features);
+
+    // 計算指定隊伍在目前局面下的分數
+    static int evaluate(const Board& board, char team);
+    static int evaluate(const FastBoard& board, char team);
+
+    // 取得指定隊伍目標區域的所有格子
+    static const std::vector<Hex>& getTargetCells(char team);
+
+    // 計算兩個格子之間的最少單步移動次數（雙倍欄座標）
+    static int stepDistance(const Hex& a, const Hex& b);
+
+    // 計算指定位置到某隊伍目標區域最近格子的距離
+    static int targetDistance(const Hex& hex, char team);
+
+private:
+    // 將一顆棋子的貢獻累加到特徵值
+    static void addPiece(EvalFeatures& features, const Hex& pos, char team);
+};
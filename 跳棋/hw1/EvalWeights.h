@@ -0,0 +1,11 @@
+﻿#pragma once  // 防止標頭檔重複包含
+
+// 評估函式的權重常數
+// 此檔案可由 tuner 工具依據對局紀錄重新產生，目前為手動設定的初始值
+// 分數單位：SCALE 分相當於勝率模型中的 1 個 logit
+struct EvalWeights {
+    static constexpr int SCALE = 100;          // 分數與 logit 的換算比例
+    static constexpr int GOAL_DISTANCE = -8;   // 所有棋子到目標區域的距離總和
+    static constexpr int STRAGGLER = -15;      // 落後最多的棋子到目標區域的距離
+    static constexpr int BLOCKING = 20;        // 佔據其他隊伍目標區域的棋子數量
+};
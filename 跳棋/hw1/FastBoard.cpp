@@ -0,0 +1,301 @@
+﻿#include "FastBoard.h"  // 包含快速棋盤類別的標頭檔
+#include "Board.h"      // 包含棋盤類別，用來取得初始局面與常數
+#include <algorithm>    // 包含演算法函式
+#include <stdexcept>    // 包含標準例外類別
+using namespace std;    // 使用標準命名空間
+
+namespace {
+
+// 座標查表範圍，涵蓋所有棋盤格子
+constexpr int MIN_Q = -6, MAX_Q = 6, MIN_R = -4, MAX_R = 4;
+constexpr int WIDTH = MAX_Q - MIN_Q + 1, HEIGHT = MAX_R - MIN_R + 1;
+
+// 有效連線的方向（與 Board::isValidConnection 相同的14個方向）
+const pair<int, int> DIRECTIONS[] = {
+    {1, 0}, {0, 1}, {-1, 1}, {-1, 0}, {0, -1}, {1, -1},                 // 距離1的六個方向
+    {2, 0}, {-2, 0}, {2, -1}, {1, 1}, {-1, 2}, {-2, 1}, {-1, -1}, {1, -2}  // 距離2的延伸方向
+};
+
+// 三個隊伍的順序，與 Layout::targets 的索引及 Board::getWinner 的檢查順序一致
+const char TEAMS[3] = { Board::RED, Board::BLUE, Board::GREEN };
+
+// 棋盤形狀的預先計算結果，所有 FastBoard 共用
+struct Layout {
+    vector<Hex> hexes;                          // 索引對應的六角座標
+    int lookup[WIDTH * HEIGHT];                 // 座標對應的索引
+    vector<vector<int>> neighbors;              // 每個格子的相鄰格子
+    vector<vector<pair<int, int>>> jumps;       // 每個格子的（跳板格, 落點格）
+    vector<char> initialCells;                  // 初始局面
+    uint64_t targets[3] = {};                   // 三個隊伍的目標區域遮罩
+
+    Layout() {
+        fill(begin(lookup), end(lookup), FastBoard::NONE);
+
+        // 只收錄可放置棋子的格子，裝飾格永遠不會改變，不需要索引
+        Board board;
+        for (const auto& [pos, value] : board.getGrid()) {
+            if (value != Board::SPACE) hexes.push_back(pos);
+        }
+        sort(hexes.begin(), hexes.end(), [](const Hex& a, const Hex& b) {
+            return a.r != b.r ? a.r < b.r : a.q < b.q;  // 固定索引順序（由上而下、由左而右）
+        });
+
+        // 佔用狀態以64位元遮罩記錄，格子數量不能超過遮罩的位元數
+        if (hexes.size() > static_cast<size_t>(FastBoard::MAX_CELLS)) {
+            throw length_error("FastBoard: board has more cells than the 64-bit occupancy mask");
+        }
+
+        for (int i = 0; i < static_cast<int>(hexes.size()); ++i) {
+            if (hexes[i].q < MIN_Q || hexes[i].q > MAX_Q || hexes[i].r < MIN_R || hexes[i].r > MAX_R) {
+                throw out_of_range("FastBoard: board cell outside the coordinate lookup table");
+            }
+            lookup[(hexes[i].r - MIN_R) * WIDTH + (hexes[i].q - MIN_Q)] = i;
+            initialCells.push_back(board.getGrid().at(hexes[i]));
+            for (int t = 0; t < 3; ++t) {
+                if (board.isInTargetArea(hexes[i], TEAMS[t])) targets[t] |= uint64_t(1) << i;
+            }
+        }
+
+        neighbors.resize(hexes.size());
+        jumps.resize(hexes.size());
+        for (int i = 0; i < static_cast<int>(hexes.size()); ++i) {
+            for (const auto& [dq, dr] : DIRECTIONS) {
+                int pivot = index(Hex(hexes[i].q + dq, hexes[i].r + dr));
+                int target = index(Hex(hexes[i].q + 2 * dq, hexes[i].r + 2 * dr));
+                if (pivot != FastBoard::NONE) neighbors[i].push_back(pivot);
+                if (pivot != FastBoard::NONE && target != FastBoard::NONE) jumps[i].push_back({ pivot, target });
+            }
+        }
+    }
+
+    // 座標轉換為索引，超出範圍時回傳 NONE
+    int index(const Hex& hex) const {
+        if (hex.q < MIN_Q || hex.q > MAX_Q || hex.r < MIN_R || hex.r > MAX_R) return FastBoard::NONE;
+        return lookup[(hex.r - MIN_R) * WIDTH + (hex.q - MIN_Q)];
+    }
+};
+
+// 取得共用的棋盤形狀（第一次呼叫時建立）
+const Layout& layout() {
+    static const Layout instance;
+    return instance;
+}
+
+// 取得索引對應的位元
+inline uint64_t bit(int index) {
+    return uint64_t(1) << index;
+}
+
+}  // namespace
+
+// 建構函式，複製共用的初始局面
+FastBoard::FastBoard() : cells(layout().initialCells) {
+    static_assert(Board::RED == 'R', "FastBoard::currentPlayer defaults to the red team");
+    for (int i = 0; i < static_cast<int>(cells.size()); ++i) {
+        if (cells[i] != Board::EMPTY) occupied |= bit(i);  // 記錄有棋子的格子
+    }
+}
+
+// 取得可放置棋子的格子數量
+int FastBoard::getCellCount() {
+    return static_cast<int>(layout().hexes.size());
+}
+
+// 將六角座標轉換為格子索引
+int FastBoard::toIndex(const Hex& hex) {
+    return layout().index(hex);
+}
+
+// 將格子索引轉換為六角座標
+Hex FastBoard::toHex(int index) {
+    return index == NONE ? Hex(-999, -999) : layout().hexes[index];
+}
+
+// 取得從指定格子一步可到達的相鄰格子
+const vector<int>& FastBoard::getNeighbors(int index) {
+    return layout().neighbors[index];
+}
+
+// 取得從指定格子出發的所有（跳板格, 落點格）組合
+const vector<pair<int, int>>& FastBoard::getJumps(int index) {
+    return layout().jumps[index];
+}
+
+// 取得指定位置的內容
+char FastBoard::at(const Hex& hex) const {
+    int index = toIndex(hex);
+    return index == NONE ? Board::SPACE : cells[index];
+}
+
+// 取得本次連續跳躍已經過的位置
+vector<Hex> FastBoard::getJumpHistory() const {
+    vector<Hex> history;
+    for (int i = 0; i < getCellCount(); ++i) {
+        if (jumpHistory & bit(i)) history.push_back(toHex(i));
+    }
+    return history;
+}
+
+// 取得獲勝隊伍的顏色
+char FastBoard::getWinner() const {
+    for (int t = 0; t < 3; ++t) {
+        uint64_t pieces = 0;  // 該隊伍棋子所在的格子
+        for (int i = 0; i < static_cast<int>(cells.size()); ++i) {
+            if (cells[i] == TEAMS[t]) pieces |= bit(i);
+        }
+        // 當該隊伍所有棋子都在目標區域時，該隊伍獲勝
+        if (pieces && !(pieces & ~layout().targets[t])) return TEAMS[t];
+    }
+    return '\0';  // 沒有獲勝者
+}
+
+// 計算跳躍可到達的格子遮罩，與 Board::getJumpMoves 相同的廣度優先搜尋
+uint64_t FastBoard::jumpMask(uint64_t occupiedMask, int from, int exclude) {
+    uint64_t visited = bit(from);  // 已訪問的格子
+    uint64_t result = 0;           // 可跳躍到的格子
+    int queue[MAX_CELLS];          // 每個格子最多進入佇列一次
+    int head = 0, tail = 0;
+    queue[tail++] = from;
+
+    while (head < tail) {
+        int current = queue[head++];
+        for (const auto& [pivot, target] : layout().jumps[current]) {
+            // 跳板格必須有棋子，落點必須是空格且尚未訪問
+            if (!(occupiedMask & bit(pivot)) || (occupiedMask & bit(target))) continue;
+            if (target == exclude || (visited & bit(target))) continue;
+            visited |= bit(target);
+            result |= bit(target);
+            queue[tail++] = target;
+        }
+    }
+    return result;
+}
+
+// 取得從指定位置可以跳躍到的所有位置
+vector<Hex> FastBoard::getJumpMoves(const Hex& from, const Hex& excludePosition) const {
+    vector<Hex> jumps;
+    int index = toIndex(from);
+    if (index == NONE) return jumps;  // 起始位置不存在
+
+    uint64_t mask = jumpMask(occupied, index, toIndex(excludePosition));
+    for (int i = 0; i < getCellCount(); ++i) {
+        if (mask & bit(i)) jumps.push_back(toHex(i));
+    }
+    return jumps;
+}
+
+// 取得當前玩家所有合法的移動
+vector<pair<Hex, Hex>> FastBoard::getLegalMoves() const {
+    vector<pair<Hex, Hex>> moves;
+
+    // 連續跳躍中只能移動指定的棋子，且不可跳回已經過的位置
+    if (isInJumpSequence()) {
+        uint64_t mask = jumpMask(occupied, mustMoveFrom, lastMoveFrom) & ~jumpHistory;
+        for (int i = 0; i < getCellCount(); ++i) {
+            if (mask & bit(i)) moves.push_back({ toHex(mustMoveFrom), toHex(i) });
+        }
+        return moves;
+    }
+
+    for (int from = 0; from < getCellCount(); ++from) {
+        if (cells[from] != currentPlayer) continue;
+
+        // 單步移動與跳躍移動的落點合併計算
+        uint64_t mask = jumpMask(occupied, from, lastMoveFrom);
+        for (int neighbor : layout().neighbors[from]) {
+            if (!(occupied & bit(neighbor))) mask |= bit(neighbor);
+        }
+        for (int i = 0; i < getCellCount(); ++i) {
+            if (mask & bit(i)) moves.push_back({ toHex(from), toHex(i) });
+        }
+    }
+    return moves;
+}
+
+// 將棋子從 from 移到 to 並更新遮罩
+void FastBoard::relocate(int from, int to) {
+    cells[to] = cells[from];
+    cells[from] = Board::EMPTY;
+    occupied = (occupied & ~bit(from)) | bit(to);
+}
+
+// 切換到下一個玩家（紅->藍->綠->紅）
+void FastBoard::switchPlayer() {
+    switch (currentPlayer) {
+    case Board::RED: currentPlayer = Board::BLUE; break;
+    case Board::BLUE: currentPlayer = Board::GREEN; break;
+    case Board::GREEN: currentPlayer = Board::RED; break;
+    }
+}
+
+// 清除跳躍狀態的所有記錄
+void FastBoard::clearJumpState() {
+    lastMoveFrom = NONE;
+    mustMoveFrom = NONE;
+    jumpHistory = 0;
+}
+
+// 停止跳躍序列並切換玩家
+void FastBoard::stopJumpSequence() {
+    clearJumpState();
+    switchPlayer();
+}
+
+// 執行棋子移動，每個分支都對應 Board::move 中的同一段規則
+bool FastBoard::move(const Hex& fromPos, const Hex& toPos) {
+    int from = toIndex(fromPos);
+    int to = toIndex(toPos);
+
+    // 連續跳躍時必須移動指定的棋子
+    if (isInJumpSequence() && from != mustMoveFrom) return false;
+
+    // 來源必須是當前玩家的棋子，目的地必須是空格
+    if (from == NONE || cells[from] != currentPlayer) return false;
+    if (to == NONE || cells[to] != Board::EMPTY) return false;
+
+    // 處於連續跳躍狀態時，只允許跳躍且不可回到已經過的位置
+    if (isInJumpSequence()) {
+        if (jumpHistory & bit(to)) return false;
+        if (!(jumpMask(occupied, from, lastMoveFrom) & bit(to))) return false;
+
+        relocate(from, to);
+        jumpHistory |= bit(to);
+
+        // 檢查是否還能繼續跳躍（排除剛才的起始位置與已經過的位置）
+        if ((jumpMask(occupied, to, from) & ~jumpHistory) == 0) {
+            clearJumpState();
+            switchPlayer();
+        }
+        else {
+            lastMoveFrom = from;
+            mustMoveFrom = to;
+        }
+        return true;
+    }
+
+    // 單步移動（距離1或2的有效連線）
+    const vector<int>& neighbors = layout().neighbors[from];
+    if (find(neighbors.begin(), neighbors.end(), to) != neighbors.end()) {
+        relocate(from, to);
+        clearJumpState();
+        switchPlayer();
+        return true;
+    }
+
+    // 跳躍移動
+    if (!(jumpMask(occupied, from, lastMoveFrom) & bit(to))) return false;
+
+    relocate(from, to);
+    jumpHistory = bit(from) | bit(to);  // 開始新的跳躍序列
+
+    // 與 Board::move 相同，第一次跳躍後的檢查不排除跳躍歷史
+    if (jumpMask(occupied, to, from) == 0) {
+        clearJumpState();
+        switchPlayer();
+    }
+    else {
+        lastMoveFrom = from;
+        mustMoveFrom = to;
+    }
+    return true;
+}
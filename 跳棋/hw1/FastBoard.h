@@ -0,0 +1,105 @@
+﻿#pragma once  // 防止標頭檔重複包含
+#include "Hex.h"    // 包含六角座標系統
+#include <cstdint>  // 包含固定寬度整數型別
+#include <utility>  // 包含pair
+#include <vector>   // 包含動態陣列容器
+
+// 以陣列與位元遮罩實作的棋盤，規則與 Board 完全相同
+// Board 的 getJumpMoves 每個搜尋節點都要掃描整個 grid，
+// 這裡改為預先計算每個格子的相鄰與跳躍表，並以 64 位元遮罩記錄佔用狀態
+class FastBoard {
+public:
+    // 不存在的格子索引
+    static constexpr int NONE = -1;
+
+    // 可放置棋子的格子上限（遮罩為64位元）
+    static constexpr int MAX_CELLS = 64;
+
+    // 建構函式，初始化為與 Board 相同的初始局面
+    FastBoard();
+
+    // 執行棋子移動，規則與 Board::move 相同
+    bool move(const Hex& from, const Hex& to);
+
+    // 中斷連續跳躍序列並切換玩家
+    void stopJumpSequence();
+
+    // 取得當前玩家的顏色
+    char getCurrentPlayer() const { return currentPlayer; }
+
+    // 檢查是否處於連續跳躍狀態
+    bool isInJumpSequence() const { return mustMoveFrom != NONE; }
+
+    // 取得必須移動的棋子位置（連續跳躍時使用）
+    Hex getMustMoveFrom() const { return toHex(mustMoveFrom); }
+
+    // 取得上一步移動的起始位置
+    Hex getLastMoveFrom() const { return toHex(lastMoveFrom); }
+
+    // 取得本次連續跳躍已經過的位置
+    std::vector<Hex> getJumpHistory() const;
+
+    // 取得獲勝隊伍的顏色（所有棋子都在目標區域），沒有時回傳 '\0'，與 Board::getWinner 相同
+    char getWinner() const;
+
+    // 取得指定位置的內容（棋子或 Board::EMPTY），不可放置棋子的位置回傳 Board::SPACE
+    char at(const Hex& hex) const;
+
+    // 取得指定格子索引的內容，索引必須介於 0 與 getCellCount() 之間
+    char at(int index) const { return cells[index]; }
+
+    // 取得從指定位置可以跳躍到的所有位置，結果與 Board::getJumpMoves 相同（順序不同）
+    std::vector<Hex> getJumpMoves(const Hex& from, const Hex& excludePosition = Hex(-999, -999)) const;
+
+    // 取得當前玩家所有合法的移動（起點, 終點），不含中斷連續跳躍
+    std::vector<std::pair<Hex, Hex>> getLegalMoves() const;
+
+    // 取得可放置棋子的格子數量
+    static int getCellCount();
+
+    // 將六角座標轉換為格子索引，不存在時回傳 NONE
+    static int toIndex(const Hex& hex);
+
+    // 將格子索引轉換為六角座標，NONE 轉換為 (-999, -999)
+    static Hex toHex(int index);
+
+    // 取得從指定格子一步可到達的相鄰格子（距離1或2的有效連線）
+    static const std::vector<int>& getNeighbors(int index);
+
+    // 取得從指定格子出發的所有（跳板格, 落點格）組合
+    static const std::vector<std::pair<int, int>>& getJumps(int index);
+
+    // 取得目前有棋子的格子遮罩
+    uint64_t getOccupied() const { return occupied; }
+
+    // 計算跳躍可到達的格子遮罩，occupiedMask 指定哪些格子有棋子
+    static uint64_t jumpMask(uint64_t occupiedMask, int from, int exclude);
+
+private:
+    // 每個格子的內容，索引與 toIndex 相同
+    std::vector<char> cells;
+
+    // 有棋子的格子遮罩
+    uint64_t occupied = 0;
+
+    // 當前玩家，預設為紅隊（與 Board::RED 相同）
+    char currentPlayer = 'R';
+
+    // 上一步移動的起始格子
+    int lastMoveFrom = NONE;
+
+    // 必須移動的棋子格子（連續跳躍時使用）
+    int mustMoveFrom = NONE;
+
+    // 本次連續跳躍已經過的格子遮罩
+    uint64_t jumpHistory = 0;
+
+    // 將棋子從 from 移到 to 並更新遮罩
+    void relocate(int from, int to);
+
+    // 清除跳躍狀態的相關記錄
+    void clearJumpState();
+
+    // 切換到下一個玩家
+    void switchPlayer();
+};
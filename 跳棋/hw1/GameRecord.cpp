@@ -0,0 +1,26 @@
+﻿#include "GameRecord.h"  // 包含對局紀錄類別的標頭檔
+#include <fstream>       // 包含檔案串流
+using namespace std;     // 使用標準命名空間
+
+// 記錄一次成功的移動
+void GameRecord::addMove(const Hex& from, const Hex& to) {
+    moves += ' ' + to_string(from.q) + ' ' + to_string(from.r) + ' ' + to_string(to.q) + ' ' + to_string(to.r);
+}
+
+// 記錄中斷連續跳躍
+void GameRecord::addStop() {
+    moves += " S";
+}
+
+// 轉換為一行對局紀錄
+string GameRecord::toString(char winner) const {
+    return string(1, winner ? winner : UNDECIDED) + moves;  // 沒有獲勝者時記為未分勝負
+}
+
+// 將這局附加到紀錄檔的最後一行
+bool GameRecord::appendTo(const string& path, char winner) const {
+    ofstream out(path, ios::app);
+    if (!out) return false;
+    out << toString(winner) << '\n';
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,31 @@
+﻿#pragma once  // 防止標頭檔重複包含
+#include "Hex.h"    // 包含六角座標系統
+#include <string>   // 包含字串類別
+
+// 對局紀錄，輸出格式即 tuner 讀取的格式：
+// 每行一局，第一個欄位是獲勝隊伍（R/B/G，未分勝負為 -），
+// 之後依序為每一步的 "起點q 起點r 終點q 終點r"，中斷連續跳躍記為 "S"
+class GameRecord {
+public:
+    // 未分勝負時的獲勝隊伍欄位
+    static constexpr char UNDECIDED = '-';
+
+    // 記錄一次成功的移動
+    void addMove(const Hex& from, const Hex& to);
+
+    // 記錄中斷連續跳躍
+    void addStop();
+
+    // 清除所有紀錄，開始新的一局
+    void clear() { moves.clear(); }
+
+    // 轉換為一行對局紀錄（不含換行）
+    std::string toString(char winner) const;
+
+    // 將這局附加到紀錄檔的最後一行
+    bool appendTo(const std::string& path, char winner) const;
+
+private:
+    // 已記錄的移動，每個欄位前都有一個空白
+    std::string moves;
+};
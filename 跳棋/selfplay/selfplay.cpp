@@ -0,0 +1,139 @@
+﻿// 自我對弈產生工具
+//
+// 三隊都以 Evaluator 的分數做一步貪婪搜尋（帶有少量隨機移動以增加多樣性），
+// 以 FastBoard 產生與執行移動，將每局寫成 GameRecord 格式供 tuner 讀取。
+// 超過最大步數仍未分勝負的對局記為 "-"，tuner 會另外統計並略過。
+//
+// 用法：selfplay <對局數> <輸出檔> [執行緒數] [起始種子] [每局最大步數]
+#include "../hw1/Eval.h"        // 包含評估類別
+#include "../hw1/FastBoard.h"   // 包含快速棋盤類別
+#include "../hw1/GameRecord.h"  // 包含對局紀錄類別
+#include <algorithm>            // 包含演算法函式
+#include <atomic>               // 包含原子變數
+#include <cstdlib>              // 包含字串轉數字函式
+#include <fstream>              // 包含檔案串流
+#include <iostream>             // 包含輸入輸出流
+#include <mutex>                // 包含互斥鎖
+#include <random>               // 包含亂數產生器
+#include <string>               // 包含字串類別
+#include <thread>               // 包含執行緒
+#include <vector>               // 包含動態陣列容器
+using namespace std;            // 使用標準命名空間
+
+namespace {
+
+// 隨機移動的機率（百分比）
+constexpr int RANDOM_MOVE_PERCENT = 10;
+
+// 解析正整數參數，格式錯誤或不是正數時回傳 false
+bool parsePositive(const char* text, long& value) {
+    char* end = nullptr;
+    value = strtol(text, &end, 10);
+    return end != text && *end == '\0' && value > 0;
+}
+
+// 從指定隊伍的角度評估局面：自己的分數減去對手中最高的分數
+int relativeScore(const FastBoard& board, char team) {
+    int best = 0;
+    bool found = false;
+    for (char other : {Board::RED, Board::BLUE, Board::GREEN}) {
+        if (other == team) continue;
+        int score = Evaluator::evaluate(board, other);
+        if (!found || score > best) {
+            best = score;
+            found = true;
+        }
+    }
+    return Evaluator::evaluate(board, team) - best;
+}
+
+// 以指定種子進行一局自我對弈，回傳一行對局紀錄
+string playGame(unsigned seed, int maxPlies) {
+    mt19937 rng(seed);
+    FastBoard board;
+    GameRecord record;
+    char winner = '\0';
+
+    for (int ply = 0; ply < maxPlies && !winner; ++ply) {
+        char team = board.getCurrentPlayer();
+        vector<pair<Hex, Hex>> moves = board.getLegalMoves();
+
+        // 連續跳躍中也可以選擇停止，以目前局面的分數作為停止的分數
+        bool canStop = board.isInJumpSequence();
+        int bestScore = canStop ? relativeScore(board, team) : 0;
+        vector<int> best;  // 分數最高的移動索引，-1 表示停止
+        if (canStop) best.push_back(-1);
+
+        if (!moves.empty() && static_cast<int>(rng() % 100) < RANDOM_MOVE_PERCENT) {
+            best.assign(1, static_cast<int>(rng() % moves.size()));
+        }
+        else {
+            for (int i = 0; i < static_cast<int>(moves.size()); ++i) {
+                FastBoard next = board;
+                next.move(moves[i].first, moves[i].second);
+                int score = relativeScore(next, team);
+                if (best.empty() || score > bestScore) {
+                    bestScore = score;
+                    best.assign(1, i);
+                }
+                else if (score == bestScore) {
+                    best.push_back(i);
+                }
+            }
+        }
+        if (best.empty()) break;  // 沒有任何合法移動
+
+        int choice = best[rng() % best.size()];  // 同分時隨機選擇
+        if (choice < 0) {
+            board.stopJumpSequence();
+            record.addStop();
+        }
+        else {
+            board.move(moves[choice].first, moves[choice].second);
+            record.addMove(moves[choice].first, moves[choice].second);
+        }
+        winner = board.getWinner();
+    }
+
+    return record.toString(winner);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    long games = 0, threadCount = max(1u, thread::hardware_concurrency()), seed = 1, maxPlies = 600;
+    if (argc < 3 || argc > 6 || !parsePositive(argv[1], games) ||
+        (argc > 3 && !parsePositive(argv[3], threadCount)) ||
+        (argc > 4 && !parsePositive(argv[4], seed)) ||
+        (argc > 5 && !parsePositive(argv[5], maxPlies))) {
+        cout << "Usage: selfplay <games> <output file> [threads] [seed] [max plies]\n";
+        return 1;
+    }
+
+    ofstream out(argv[2], ios::app);
+    if (!out) {
+        cout << "Cannot open " << argv[2] << "\n";
+        return 1;
+    }
+
+    atomic<long> nextGame{ 0 };  // 下一局的編號
+    atomic<long> decided{ 0 };   // 分出勝負的對局數
+    mutex outputMutex;
+    vector<thread> workers;
+
+    for (long t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&] {
+            long game;
+            while ((game = nextGame++) < games) {
+                string line = playGame(static_cast<unsigned>(seed + game), static_cast<int>(maxPlies));
+                if (line[0] != GameRecord::UNDECIDED) decided++;
+                lock_guard<mutex> lock(outputMutex);
+                out << line << '\n';
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    cout << "Wrote " << games << " games (" << decided << " decided) to " << argv[2] << "\n";
+    return 0;
+}
@@ -0,0 +1,349 @@
+﻿// 評估權重調整工具（Texel 調參法）
+//
+// 讀取自我對弈的對局紀錄，以 FastBoard 重播每一局取得所有局面與最終勝負，
+// 重播結束時的獲勝隊伍必須與紀錄的勝負相同，否則整局捨棄，
+// 以多執行緒的梯度下降最小化勝率預測誤差，最後輸出 EvalWeights.h。
+//
+// 對局紀錄格式：每行一局，第一個欄位是獲勝隊伍（R/B/G，未分勝負為 -），
+// 之後依序為每一步的 "起點q 起點r 終點q 終點r"，
+// 連續跳躍中選擇停止時以單獨的 "S" 表示。例如：
+//   R 0 -3 0 -1 S -5 1 -4 1 ...
+// 對局紀錄由 selfplay 工具產生，或由遊戲程式在每局結束時附加到 games.txt（見 GameRecord）。
+//
+// 用法：tuner <對局紀錄檔> [輸出標頭檔] [訓練回合數] [執行緒數]
+// 輸出標頭檔預設為 ../hw1/EvalWeights.h（從 tuner 專案目錄執行時即為遊戲程式使用的標頭檔）
+#include "../hw1/Eval.h"       // 包含評估類別（同時包含棋盤類別）
+#include "../hw1/FastBoard.h"  // 包含快速棋盤類別，用於重播對局
+#include <algorithm>           // 包含演算法函式
+#include <atomic>              // 包含原子變數
+#include <cctype>              // 包含字元分類函式
+#include <chrono>              // 包含計時工具
+#include <cmath>               // 包含數學函式
+#include <cstdint>             // 包含固定寬度整數型別
+#include <cstdlib>             // 包含字串轉數字函式
+#include <fstream>             // 包含檔案串流
+#include <iostream>            // 包含輸入輸出流
+#include <string>              // 包含字串類別
+#include <thread>              // 包含執行緒
+#include <vector>              // 包含動態陣列容器
+using namespace std;           // 使用標準命名空間
+
+namespace {
+
+// 三個隊伍的順序，特徵與勝負標記都依此排列
+const char TEAMS[3] = { Board::RED, Board::BLUE, Board::GREEN };
+
+// 壓縮後的訓練局面：三隊的特徵值與獲勝隊伍索引
+// 以 int16 儲存以降低記憶體用量，1 億個局面約需 2GB
+struct PackedPosition {
+    int16_t features[3][FEATURE_COUNT];  // 每隊的特徵值
+    uint8_t winner;                      // 獲勝隊伍在 TEAMS 中的索引
+};
+
+// 每次從檔案讀入並交給執行緒處理的對局數
+constexpr size_t GAMES_PER_BATCH = 1 << 16;
+
+// 重播一局對局紀錄的結果
+enum class ReplayResult {
+    ACCEPTED,   // 已加入訓練資料
+    UNDECIDED,  // 未分勝負，沒有訓練標記
+    REJECTED    // 格式錯誤、出現不合法的移動或勝負與重播結果不符
+};
+
+// 解析正整數參數，格式錯誤或不是正數時回傳 false
+bool parsePositive(const char* text, int& value) {
+    char* end = nullptr;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed <= 0 || parsed > 1000000) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// 將隊伍字元轉換為 TEAMS 中的索引，未知隊伍回傳 -1
+int teamIndex(char team) {
+    for (int i = 0; i < 3; ++i) {
+        if (TEAMS[i] == team) return i;
+    }
+    return -1;
+}
+
+// 跳過空白，回傳目前的欄位是否只有一個字元
+bool singleCharField(const char*& cursor) {
+    while (isspace(static_cast<unsigned char>(*cursor))) ++cursor;
+    return *cursor != '\0' && (cursor[1] == '\0' || isspace(static_cast<unsigned char>(cursor[1])));
+}
+
+// 讀取下一個整數欄位，格式錯誤時回傳 false
+bool readInt(const char*& cursor, int& value) {
+    char* end = nullptr;
+    long parsed = strtol(cursor, &end, 10);
+    if (end == cursor || (*end != '\0' && !isspace(static_cast<unsigned char>(*end)))) return false;
+    value = static_cast<int>(parsed);
+    cursor = end;
+    return true;
+}
+
+// 重播一局對局紀錄，將每個非連續跳躍中的局面加入 out
+// 直接掃描字串而不使用字串流，重播大量對局時解析不會成為瓶頸
+ReplayResult replayGame(const string& line, vector<PackedPosition>& out) {
+    const char* cursor = line.c_str();
+    if (!singleCharField(cursor)) return ReplayResult::REJECTED;
+
+    char label = *cursor++;
+    int winner = teamIndex(label);
+    if (label == '-') return ReplayResult::UNDECIDED;  // 未分勝負的對局沒有訓練標記
+    if (winner < 0) return ReplayResult::REJECTED;
+
+    FastBoard board;  // 從初始局面開始重播
+    while (true) {
+        bool single = singleCharField(cursor);
+        if (*cursor == '\0') break;
+        if (single && *cursor == 'S') {
+            if (!board.isInJumpSequence()) return ReplayResult::REJECTED;
+            board.stopJumpSequence();
+            ++cursor;
+            continue;
+        }
+
+        // 只記錄安靜局面，連續跳躍中途的局面不具代表性
+        if (!board.isInJumpSequence()) {
+            PackedPosition pos;
+            for (int t = 0; t < 3; ++t) {
+                EvalFeatures features = Evaluator::extract(board, TEAMS[t]);
+                for (int i = 0; i < FEATURE_COUNT; ++i) {
+                    pos.features[t][i] = static_cast<int16_t>(features[i]);
+                }
+            }
+            pos.winner = static_cast<uint8_t>(winner);
+            out.push_back(pos);
+        }
+
+        Hex from, to;
+        if (!readInt(cursor, from.q) || !readInt(cursor, from.r) ||
+            !readInt(cursor, to.q) || !readInt(cursor, to.r)) return ReplayResult::REJECTED;
+        if (!board.move(from, to)) return ReplayResult::REJECTED;
+    }
+
+    // 截斷的紀錄或標錯的獲勝隊伍不能作為訓練標記
+    if (board.getWinner() != TEAMS[winner]) return ReplayResult::REJECTED;
+    return ReplayResult::ACCEPTED;
+}
+
+// 以多執行緒重播一批對局，結果依對局順序附加到 positions
+// undecided 與 rejected 分別累加未分勝負與格式錯誤的對局數
+void replayBatch(const vector<string>& games, int threadCount, vector<PackedPosition>& positions,
+    size_t& undecided, size_t& rejected) {
+    vector<vector<PackedPosition>> results(threadCount);
+    atomic<size_t> undecidedCount{ 0 }, rejectedCount{ 0 };
+    vector<thread> workers;
+
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t] {
+            // 每個執行緒處理連續的一段對局
+            size_t begin = games.size() * t / threadCount;
+            size_t end = games.size() * (t + 1) / threadCount;
+            for (size_t i = begin; i < end; ++i) {
+                size_t before = results[t].size();
+                ReplayResult result = replayGame(games[i], results[t]);
+                if (result == ReplayResult::UNDECIDED) {
+                    undecidedCount++;
+                }
+                else if (result == ReplayResult::REJECTED) {
+                    results[t].resize(before);  // 捨棄格式錯誤的整局
+                    rejectedCount++;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    for (const auto& result : results) {
+        positions.insert(positions.end(), result.begin(), result.end());
+    }
+    undecided += undecidedCount;
+    rejected += rejectedCount;
+}
+
+// 計算單一局面對損失與梯度的貢獻
+// 預測方式：三隊分數經 softmax 得到各隊勝率，與實際勝負計算平方誤差
+double accumulate(const PackedPosition& pos, const double weights[FEATURE_COUNT], double gradient[FEATURE_COUNT]) {
+    double logits[3];
+    for (int t = 0; t < 3; ++t) {
+        double score = 0.0;
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            score += weights[i] * pos.features[t][i];
+        }
+        logits[t] = score / EvalWeights::SCALE;
+    }
+
+    // softmax，先減去最大值避免溢位
+    double maxLogit = max(logits[0], max(logits[1], logits[2]));
+    double prob[3];
+    double sum = 0.0;
+    for (int t = 0; t < 3; ++t) {
+        prob[t] = exp(logits[t] - maxLogit);
+        sum += prob[t];
+    }
+
+    double loss = 0.0;
+    double error[3];   // 對各隊勝率的偏微分 2(p - y)
+    double weighted = 0.0;
+    for (int t = 0; t < 3; ++t) {
+        prob[t] /= sum;
+        double diff = prob[t] - (pos.winner == t ? 1.0 : 0.0);
+        loss += diff * diff;
+        error[t] = 2.0 * diff;
+        weighted += error[t] * prob[t];
+    }
+
+    // 經 softmax 反傳到各隊分數，再乘上特徵值得到權重的梯度
+    for (int t = 0; t < 3; ++t) {
+        double dLogit = prob[t] * (error[t] - weighted) / EvalWeights::SCALE;
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            gradient[i] += dLogit * pos.features[t][i];
+        }
+    }
+    return loss;
+}
+
+// 以多執行緒計算整個資料集的平均損失與梯度
+double computeGradient(const vector<PackedPosition>& positions, const double weights[FEATURE_COUNT],
+    double gradient[FEATURE_COUNT], int threadCount) {
+    vector<array<double, FEATURE_COUNT>> partialGradients(threadCount);
+    vector<double> partialLoss(threadCount, 0.0);
+    vector<thread> workers;
+
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t] {
+            // 每個執行緒累加自己的部分，最後再合併以避免同步
+            double localGradient[FEATURE_COUNT] = {};
+            double localLoss = 0.0;
+            size_t begin = positions.size() * t / threadCount;
+            size_t end = positions.size() * (t + 1) / threadCount;
+            for (size_t i = begin; i < end; ++i) {
+                localLoss += accumulate(positions[i], weights, localGradient);
+            }
+            for (int i = 0; i < FEATURE_COUNT; ++i) {
+                partialGradients[t][i] = localGradient[i];
+            }
+            partialLoss[t] = localLoss;
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    double loss = 0.0;
+    for (int i = 0; i < FEATURE_COUNT; ++i) gradient[i] = 0.0;
+    for (int t = 0; t < threadCount; ++t) {
+        loss += partialLoss[t];
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            gradient[i] += partialGradients[t][i];
+        }
+    }
+
+    double n = static_cast<double>(positions.size());
+    for (int i = 0; i < FEATURE_COUNT; ++i) gradient[i] /= n;
+    return loss / n;
+}
+
+// 將調整後的權重寫成可供遊戲程式編譯的標頭檔
+bool writeWeightsHeader(const string& path, const int weights[FEATURE_COUNT], size_t positionCount, double loss) {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+
+    // 以 UTF-8 BOM 與 CRLF 輸出，與專案內其他原始檔一致
+    out << "\xEF\xBB\xBF";
+    out << "#pragma once  // 防止標頭檔重複包含\r\n"
+        << "\r\n"
+        << "// 評估函式的權重常數\r\n"
+        << "// 此檔案由 tuner 工具自動產生：" << positionCount << " 個局面，平均誤差 " << loss << "\r\n"
+        << "// 分數單位：SCALE 分相當於勝率模型中的 1 個 logit\r\n"
+        << "struct EvalWeights {\r\n"
+        << "    static constexpr int SCALE = " << EvalWeights::SCALE << ";          // 分數與 logit 的換算比例\r\n"
+        << "    static constexpr int GOAL_DISTANCE = " << weights[GOAL_DISTANCE] << ";   // 所有棋子到目標區域的距離總和\r\n"
+        << "    static constexpr int STRAGGLER = " << weights[STRAGGLER] << ";      // 落後最多的棋子到目標區域的距離\r\n"
+        << "    static constexpr int BLOCKING = " << weights[BLOCKING] << ";        // 佔據其他隊伍目標區域的棋子數量\r\n"
+        << "};\r\n";
+    return static_cast<bool>(out);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    string gamesPath = argc > 1 ? argv[1] : "";
+    string outputPath = argc > 2 ? argv[2] : "../hw1/EvalWeights.h";
+    int epochs = 300;
+    int threadCount = max(1, static_cast<int>(thread::hardware_concurrency()));
+    if (argc < 2 || argc > 5 || (argc > 3 && !parsePositive(argv[3], epochs)) ||
+        (argc > 4 && !parsePositive(argv[4], threadCount))) {
+        cout << "Usage: tuner <games file> [output header] [epochs] [threads]\n";
+        return 1;
+    }
+
+    ifstream in(gamesPath);
+    if (!in) {
+        cout << "Cannot open " << gamesPath << "\n";
+        return 1;
+    }
+
+    auto startTime = chrono::steady_clock::now();
+
+    // 分批讀取對局紀錄，避免一次把整個檔案的文字載入記憶體
+    vector<PackedPosition> positions;
+    vector<string> batch;
+    string line;
+    size_t gameCount = 0, undecidedCount = 0, rejectedCount = 0;
+    while (true) {
+        bool more = static_cast<bool>(getline(in, line));
+        if (more && !line.empty()) batch.push_back(line);
+        if (batch.size() == GAMES_PER_BATCH || (!more && !batch.empty())) {
+            gameCount += batch.size();
+            replayBatch(batch, threadCount, positions, undecidedCount, rejectedCount);
+            batch.clear();
+        }
+        if (!more) break;
+    }
+
+    auto loadTime = chrono::steady_clock::now();
+    cout << "Loaded " << positions.size() << " positions from " << gameCount << " games ("
+        << undecidedCount << " undecided, " << rejectedCount << " rejected) in "
+        << chrono::duration<double>(loadTime - startTime).count() << "s\n";
+    if (positions.empty()) return 1;
+
+    // 以目前編譯進程式的權重作為起點，使用 Adam 進行全批次梯度下降
+    double weights[FEATURE_COUNT];
+    for (int i = 0; i < FEATURE_COUNT; ++i) weights[i] = Evaluator::WEIGHTS[i];
+
+    const double learningRate = 1.0, beta1 = 0.9, beta2 = 0.999, epsilon = 1e-8;
+    double m[FEATURE_COUNT] = {}, v[FEATURE_COUNT] = {};
+    double gradient[FEATURE_COUNT];
+    double loss = 0.0;
+
+    for (int epoch = 1; epoch <= epochs; ++epoch) {
+        loss = computeGradient(positions, weights, gradient, threadCount);
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            m[i] = beta1 * m[i] + (1 - beta1) * gradient[i];
+            v[i] = beta2 * v[i] + (1 - beta2) * gradient[i] * gradient[i];
+            double mHat = m[i] / (1 - pow(beta1, epoch));
+            double vHat = v[i] / (1 - pow(beta2, epoch));
+            weights[i] -= learningRate * mHat / (sqrt(vHat) + epsilon);
+        }
+        if (epoch % 10 == 0 || epoch == epochs) {
+            cout << "Epoch " << epoch << " loss " << loss << " weights";
+            for (double w : weights) cout << ' ' << w;
+            cout << "\n";
+        }
+    }
+
+    int rounded[FEATURE_COUNT];
+    for (int i = 0; i < FEATURE_COUNT; ++i) rounded[i] = static_cast<int>(lround(weights[i]));
+
+    if (!writeWeightsHeader(outputPath, rounded, positions.size(), loss)) {
+        cout << "Cannot write " << outputPath << "\n";
+        return 1;
+    }
+
+    auto endTime = chrono::steady_clock::now();
+    cout << "Wrote " << outputPath << " in "
+        << chrono::duration<double>(endTime - startTime).count() << "s total\n";
+    return 0;
+}